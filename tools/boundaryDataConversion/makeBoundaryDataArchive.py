@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+
+# This script converts the boundary data of a patch, as read by the
+# timeVaryingMappedFluctuatingFixedValue and timeVaryingMappedInletOutlet
+# boundary conditions from constant/boundaryData/<patchName>/points and the
+# time directories next to it, into a single boundary data archive,
+# constant/boundaryData/<patchName>/archive.  When the archive is there the
+# boundary conditions read it instead of the time directories, so they can
+# be removed once the archive is written.
+#
+# The archive layout is described in src/finiteVolume/boundaryDataArchive/
+# boundaryDataArchive.H.  It is written in this machine's byte order with
+# double precision scalars, so convert on a machine like the one the solver
+# runs on.
+#
+# Usage:  ./makeBoundaryDataArchive.py [patchDirectory] [fieldName] ...
+#
+# e.g.    ./makeBoundaryDataArchive.py constant/boundaryData/west U T k
+
+
+from __future__ import print_function
+
+import os
+import re
+import struct
+import sys
+from array import array
+
+
+magic = b'SOWFABDA'
+version = 1
+scalarSize = 8
+nameLength = 32
+
+number = re.compile(r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?')
+
+
+
+
+# Read all the numbers of an OpenFOAM ASCII file, after its header.
+def readNumbers(fileName):
+    fid = open(fileName,'r')
+    text = fid.read()
+    fid.close()
+
+    # Remove the comments and the FoamFile header.
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    text = re.sub(r'//[^\n]*', ' ', text)
+    text = re.sub(r'FoamFile\s*\{.*?\}', ' ', text, flags=re.S)
+
+    return [float(x) for x in number.findall(text)]
+
+
+
+
+# User input
+if len(sys.argv) < 3:
+    print('Usage: ' + sys.argv[0] + ' [patchDirectory] [fieldName] ...')
+    sys.exit(1)
+
+patchDir = sys.argv[1]
+fieldNames = sys.argv[2:]
+
+for fieldName in fieldNames:
+    if len(fieldName) >= nameLength:
+        print('Error: field name ' + fieldName + ' is too long')
+        sys.exit(1)
+
+
+
+# Read the points.  The file is the number of points followed by the points.
+pointData = readNumbers(os.path.join(patchDir,'points'))
+nPoints = int(pointData[0])
+points = pointData[1:]
+if len(points) != 3*nPoints:
+    print('Error: expected ' + str(nPoints) + ' points in ' + os.path.join(patchDir,'points'))
+    sys.exit(1)
+
+print('Number of points = ', nPoints)
+
+
+
+# Find the time directories, in time order.
+times = []
+for entry in os.listdir(patchDir):
+    if os.path.isdir(os.path.join(patchDir,entry)):
+        try:
+            times.append((float(entry),entry))
+        except ValueError:
+            pass
+times.sort()
+
+if len(times) == 0:
+    print('Error: no time directories in ' + patchDir)
+    sys.exit(1)
+
+print('Number of times = ', len(times))
+
+
+
+# Each field file is the average followed by the number of values and the
+# values.  Find the number of components from the layout.
+def readField(fileName):
+    data = readNumbers(fileName)
+    for nComponents in [1, 3, 6, 9]:
+        if (len(data) == nComponents + 1 + nPoints*nComponents) and (int(data[nComponents]) == nPoints):
+            return nComponents, data[0:nComponents], data[nComponents+1:]
+
+    print('Error: ' + fileName + ' does not hold ' + str(nPoints) + ' scalar, vector, symmTensor or tensor values')
+    sys.exit(1)
+
+nComponents = []
+for fieldName in fieldNames:
+    n, average, values = readField(os.path.join(patchDir,times[0][1],fieldName))
+    nComponents.append(n)
+
+
+
+# Write the header: the sizes, the field names and components, and the points,
+# padded to a multiple of 8 bytes.
+headerSize = 8 + 2*4 + 3*8 + len(fieldNames)*(nameLength + 8) + 3*nPoints*scalarSize
+padding = (8 - headerSize % 8) % 8
+headerSize += padding
+
+archiveFile = os.path.join(patchDir,'archive')
+fid = open(archiveFile,'wb')
+
+fid.write(magic)
+fid.write(struct.pack('=iiqqq', version, scalarSize, nPoints, len(fieldNames), headerSize))
+for i in range(len(fieldNames)):
+    fid.write(fieldNames[i].encode('ascii').ljust(nameLength, b'\0'))
+    fid.write(struct.pack('=q', nComponents[i]))
+array('d', points).tofile(fid)
+fid.write(b'\0'*padding)
+
+
+
+# Write a slab per time: the time, then each field's average and values.
+for time in times:
+    fid.write(struct.pack('=d', time[0]))
+    for i in range(len(fieldNames)):
+        fieldFile = os.path.join(patchDir,time[1],fieldNames[i])
+        n, average, values = readField(fieldFile)
+        if n != nComponents[i]:
+            print('Error: ' + fieldFile + ' has ' + str(n) + ' components but ' + str(nComponents[i]) + ' were expected')
+            sys.exit(1)
+        array('d', average).tofile(fid)
+        array('d', values).tofile(fid)
+    print('Time ' + time[1])
+
+fid.close()
+
+print('Wrote ' + archiveFile)
@@ -0,0 +1,189 @@
+#!/usr/bin/env python
+
+# This script reads the binary record files written by the turbine models and
+# the lidar function objects when they are run with outputFormat binary, and
+# writes the text files they write with outputFormat text, so that existing
+# post-processing scripts can be used on them.
+#
+# The file layout is described in src/fileFormats/bufferedOutput/
+# outputRecordFile.H.  A file dir/name.bin is written as text to dir/name, or,
+# for files with a directory per record such as the lidar beam data, to
+# dir/../<record time>/name.  The values are stored in single precision, so
+# the last digit written can differ from that of the text output.  The time
+# names are not stored, so the time column of the turbine files is written
+# from the time at the precision of the values, which is the time name unless
+# timePrecision or timeFormat differ from writePrecision and general.
+#
+# Usage:  ./binaryOutputToText.py [file.bin or directory] ...
+#
+# A directory is searched for .bin files, including its subdirectories.
+#
+# e.g.    ./binaryOutputToText.py postProcessing/turbineOutput/0
+#         ./binaryOutputToText.py postProcessing/lidar1/0/uVel.bin
+#
+# The reader can also be used on its own:
+#
+#         import binaryOutputToText as bo
+#         header, records = bo.readRecordFile('bladePointAlpha.bin')
+#
+# where each record is (time, rows) and each row is (leading, values).
+
+
+from __future__ import print_function
+
+import os
+import struct
+import sys
+from array import array
+
+
+magic = b'SOWFAREC'
+
+
+
+
+# Unpack native doubles ('d') or floats ('f') into a list.
+def unpackArray(typeCode, data):
+    a = array(typeCode)
+    if hasattr(a, 'frombytes'):
+        a.frombytes(data)
+    else:
+        a.fromstring(data)
+    return a.tolist()
+
+
+
+
+# Read a record file, returning its header and records.
+def readRecordFile(fileName):
+    fid = open(fileName,'rb')
+
+    if fid.read(8) != magic:
+        print('Error: ' + fileName + ' is not a SOWFA binary record file')
+        sys.exit(1)
+
+    version, recordDirectories, nLeading, nComponents, precision, nRows, headerLength = \
+        struct.unpack('=7i', fid.read(7*4))
+
+    header = {}
+    header['version'] = version
+    header['recordDirectories'] = (recordDirectories != 0)
+    header['nLeading'] = nLeading
+    header['nComponents'] = nComponents
+    header['precision'] = precision
+    header['line'] = fid.read(headerLength).decode('ascii')
+    header['rowValues'] = list(struct.unpack('=' + str(nRows) + 'i', fid.read(nRows*4)))
+
+    recordSize = 8
+    for nValues in header['rowValues']:
+        recordSize += 8*nLeading + 4*nValues
+
+    records = []
+    while True:
+        data = fid.read(recordSize)
+        if len(data) < recordSize:
+            break
+
+        time = struct.unpack_from('=d', data, 0)[0]
+        offset = 8
+        rows = []
+        for nValues in header['rowValues']:
+            leading = unpackArray('d', data[offset:offset + 8*nLeading])
+            offset += 8*nLeading
+            values = unpackArray('f', data[offset:offset + 4*nValues])
+            offset += 4*nValues
+            rows.append((leading, values))
+        records.append((time, rows))
+
+    fid.close()
+
+    return header, records
+
+
+
+
+# Format a number as the solver's text output does.
+def formatNumber(x, precision):
+    return '%.*g' % (precision, x)
+
+
+
+
+# Write the rows of a record as text lines.
+def writeRows(fid, header, rows):
+    p = header['precision']
+    nComponents = header['nComponents']
+
+    for leading, values in rows:
+        line = ''
+        for x in leading:
+            line += formatNumber(x,p) + ' '
+
+        # A row of a single value ends with the value, and a row of several
+        # with a space after the last.
+        groups = []
+        for i in range(0, len(values), nComponents):
+            if nComponents == 1:
+                groups.append(formatNumber(values[i],p))
+            else:
+                groups.append('(' + ' '.join([formatNumber(x,p) for x in values[i:i+nComponents]]) + ')')
+        if len(groups) == 1:
+            line += groups[0]
+        else:
+            line += ''.join([g + ' ' for g in groups])
+
+        fid.write(line + '\n')
+
+
+
+
+# Convert one record file to text.
+def convert(fileName):
+    header, records = readRecordFile(fileName)
+
+    dirName = os.path.dirname(fileName)
+    name = os.path.basename(fileName)
+    if name.endswith('.bin'):
+        name = name[:-4]
+
+    if header['recordDirectories']:
+        # Each record in its own directory, named by its time.
+        for time, rows in records:
+            recordDir = os.path.join(os.path.dirname(os.path.abspath(fileName)), '..', '%g' % time)
+            recordDir = os.path.normpath(recordDir)
+            if not os.path.isdir(recordDir):
+                os.makedirs(recordDir)
+            fid = open(os.path.join(recordDir,name),'w')
+            if header['line']:
+                fid.write(header['line'] + '\n')
+            writeRows(fid, header, rows)
+            fid.close()
+    else:
+        # Records separated by a blank line.
+        fid = open(os.path.join(dirName,name),'w')
+        if header['line']:
+            fid.write(header['line'] + '\n')
+        for time, rows in records:
+            writeRows(fid, header, rows)
+            fid.write('\n')
+        fid.close()
+
+    print('Converted ' + fileName + ': ' + str(len(records)) + ' records')
+
+
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print('Usage: ' + sys.argv[0] + ' [file.bin or directory] ...')
+        sys.exit(1)
+
+    for arg in sys.argv[1:]:
+        if os.path.isdir(arg):
+            for dirPath, dirNames, fileNames in os.walk(arg):
+                dirNames.sort()
+                for entry in sorted(fileNames):
+                    if entry.endswith('.bin'):
+                        convert(os.path.join(dirPath,entry))
+        else:
+            convert(arg)
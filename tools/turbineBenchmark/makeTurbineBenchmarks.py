@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+
+# This script generates the cases of the turbine model benchmark suites from
+# the template case exampleCases/benchmark.turbineTestHarness.  Each case is
+# a block mesh with a rows x columns layout of NREL 5-MW turbines in uniform
+# inflow, run with turbineTestHarness.ALMAdvanced and the phase profile on
+# (see src/meshTools/phaseProfile/phaseProfile.H).  The cases are fully set
+# by the suite definitions below, so a suite generated and run twice times
+# the same work.
+#
+# The suites are:
+#
+#   regression   Layouts of 1, 4 and 9 turbines, each on 1 and 4 cores, to
+#                compare against the results of a baseline build.
+#   strong       One 3 x 3 layout and mesh on 1 to 32 cores.
+#   weak         Layouts that grow with the number of cores, 1 turbine on 1
+#                core to 32 turbines on 32 cores, so with one turbine and
+#                roughly the same number of cells per core.
+#
+# Usage:  ./makeTurbineBenchmarks.py [suite] [output directory]
+#
+# e.g.    ./makeTurbineBenchmarks.py regression benchmarks
+#
+# The suite defaults to regression and the output directory to
+# benchmarks.<suite>.  Each case is written to a directory named
+# <suite>.<rows>x<columns>.<cells>.np<cores>, and is run with its
+# runscript.benchmark.  A script runBenchmarks in the output directory runs
+# them all in turn.  Then
+#
+#         ./phaseProfileTable.py --scaling strong benchmarks.strong/*
+#
+# tabulates the phases of the cases (see phaseProfileTable.py).
+
+
+from __future__ import print_function
+
+import os
+import re
+import shutil
+import sys
+
+
+# Rotor diameter of the NREL 5-MW turbine (m).
+D = 126.0
+
+# Turbine spacing in the streamwise (x) and lateral (y) directions, and the
+# margins of the domain around the layout, in rotor diameters.
+spacingX = 7.0
+spacingY = 5.0
+upstream = 3.0
+downstream = 7.0
+lateral = 3.0
+height = 2.5
+
+# Cells per rotor diameter, and the projection width in cells.
+cellsPerD = 8
+epsilonCells = 2.0
+
+# Each suite is a list of (rows, columns, cores).
+suites = {}
+suites['regression'] = [(1,1,1), (1,1,4), (2,2,1), (2,2,4), (3,3,1), (3,3,4)]
+suites['strong'] = [(3,3,1), (3,3,2), (3,3,4), (3,3,8), (3,3,16), (3,3,32)]
+suites['weak'] = [(1,1,1), (1,2,2), (2,2,4), (2,4,8), (4,4,16), (4,8,32)]
+
+
+
+
+# Split nCores into (x y z) partitions for the simple decomposition, giving
+# each prime factor to the direction with the most cells per partition.
+def decompOrder(nCores, n):
+    order = [1, 1, 1]
+    factors = []
+    m = nCores
+    p = 2
+    while m > 1:
+        while m % p == 0:
+            factors.append(p)
+            m //= p
+        p += 1
+
+    for f in sorted(factors, reverse=True):
+        i = max(range(3), key=lambda k: float(n[k])/order[k])
+        order[i] *= f
+
+    return order
+
+
+
+
+# Set an entry of a setUp file, keeping its comment in line.
+def setEntry(text, name, value):
+    pattern = re.compile(r'^(' + name + r'\s+)([^;]*;)(\s*)', re.MULTILINE)
+    if not pattern.search(text):
+        print('Error: no entry ' + name + ' in setUp')
+        sys.exit(1)
+    width = lambda m: len(m.group(2)) + len(m.group(3))
+    return pattern.sub(lambda m: m.group(1) + (value + ';').ljust(width(m) - 1) + ' ', text, count=1)
+
+
+
+
+# Write the setUp file of a case.
+def writeSetUp(caseDir, rows, columns, nCores):
+    dx = D/cellsPerD
+    xMax = (upstream + (rows - 1)*spacingX + downstream)*D
+    yMax = (2.0*lateral + (columns - 1)*spacingY)*D
+    zMax = height*D
+    n = [int(round(xMax/dx)), int(round(yMax/dx)), int(round(zMax/dx))]
+
+    fileName = os.path.join(caseDir,'setUp')
+    text = open(fileName).read()
+    text = setEntry(text, 'xMax', '%.1f' % xMax)
+    text = setEntry(text, 'yMax', '%.1f' % yMax)
+    text = setEntry(text, 'zMax', '%.1f' % zMax)
+    text = setEntry(text, 'nx', str(n[0]))
+    text = setEntry(text, 'ny', str(n[1]))
+    text = setEntry(text, 'nz', str(n[2]))
+    text = setEntry(text, 'nCores', str(nCores))
+    text = setEntry(text, 'decompType', 'simple')
+    text = setEntry(text, 'decompOrder', '(%d %d %d)' % tuple(decompOrder(nCores, n)))
+    open(fileName,'w').write(text)
+
+    return n[0]*n[1]*n[2]
+
+
+
+
+# Write the turbineArrayProperties of a case, taking the turbine entry of the
+# template as that of every turbine.
+def writeTurbineArray(caseDir, rows, columns):
+    fileName = os.path.join(caseDir,'constant','turbineArrayProperties')
+    text = open(fileName).read()
+
+    start = text.find('turbine0')
+    end = text.find('}', start)
+    if (start < 0) or (end < 0):
+        print('Error: no turbine0 entry in ' + fileName)
+        sys.exit(1)
+    header = text[:start]
+    turbine = text[start:end+1]
+
+    epsilon = epsilonCells*D/cellsPerD
+    turbine = re.sub(r'(bladeEpsilon\s+)\([^)]*\)', r'\g<1>(%.2f 0.0 0.0)' % epsilon, turbine)
+    turbine = re.sub(r'(nacelleEpsilon\s+)\([^)]*\)', r'\g<1>(%.2f %.2f 0.0)' % (epsilon,epsilon), turbine)
+    turbine = re.sub(r'(towerEpsilon\s+)\([^)]*\)', r'\g<1>(%.2f %.2f 0.0)' % (epsilon,epsilon), turbine)
+
+    text = header
+    i = 0
+    for r in range(rows):
+        for c in range(columns):
+            x = (upstream + r*spacingX)*D
+            y = (lateral + c*spacingY)*D
+            entry = turbine.replace('turbine0', 'turbine%d' % i, 1)
+            entry = re.sub(r'(baseLocation\s+)\([^)]*\)', r'\g<1>(%.1f %.1f 0.0)' % (x,y), entry)
+            text += entry + '\n\n'
+            i += 1
+
+    open(fileName,'w').write(text)
+
+
+
+
+# Set the number of cores of a case's run script.
+def writeRunScript(caseDir, nCores):
+    fileName = os.path.join(caseDir,'runscript.benchmark')
+    text = open(fileName).read()
+    text = re.sub(r'^cores=\d+', 'cores=%d' % nCores, text, count=1, flags=re.MULTILINE)
+    open(fileName,'w').write(text)
+
+
+
+
+if __name__ == '__main__':
+    suite = 'regression'
+    if len(sys.argv) > 1:
+        suite = sys.argv[1]
+    if suite not in suites:
+        print('Usage: ' + sys.argv[0] + ' [' + '|'.join(sorted(suites)) + '] [output directory]')
+        sys.exit(1)
+
+    outDir = 'benchmarks.' + suite
+    if len(sys.argv) > 2:
+        outDir = sys.argv[2]
+
+    template = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..',
+                            'exampleCases', 'benchmark.turbineTestHarness')
+    template = os.path.normpath(template)
+
+    if not os.path.isdir(outDir):
+        os.makedirs(outDir)
+
+    caseNames = []
+    for rows, columns, nCores in suites[suite]:
+        tmpDir = os.path.join(outDir, 'tmp.case')
+        if os.path.isdir(tmpDir):
+            shutil.rmtree(tmpDir)
+        shutil.copytree(template, tmpDir)
+
+        nCells = writeSetUp(tmpDir, rows, columns, nCores)
+        writeTurbineArray(tmpDir, rows, columns)
+        writeRunScript(tmpDir, nCores)
+
+        caseName = '%s.%dx%d.%d.np%d' % (suite, rows, columns, nCells, nCores)
+        caseDir = os.path.join(outDir, caseName)
+        if os.path.isdir(caseDir):
+            shutil.rmtree(caseDir)
+        os.rename(tmpDir, caseDir)
+        caseNames.append(caseName)
+
+        print('Created ' + caseDir + ': ' + str(rows*columns) + ' turbines, ' +
+              str(nCells) + ' cells, ' + str(nCores) + ' cores')
+
+    fid = open(os.path.join(outDir,'runBenchmarks'),'w')
+    fid.write('#!/bin/bash\n\n# Runs the ' + suite + ' benchmark cases in turn.\n\n')
+    for caseName in caseNames:
+        fid.write('(cd ' + caseName + ' && ./runscript.benchmark)\n')
+    fid.close()
+    os.chmod(os.path.join(outDir,'runBenchmarks'), 0o755)
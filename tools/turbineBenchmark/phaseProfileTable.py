@@ -0,0 +1,247 @@
+#!/usr/bin/env python
+
+# This script tabulates the phase profiles written at the end of a run by the
+# turbine models, the lidar function objects, ABLSolver and the turbine test
+# harnesses when they are run with profilePhases on (see
+# src/meshTools/phaseProfile/phaseProfile.H), such as those of the benchmark
+# cases made by makeTurbineBenchmarks.py.
+#
+# Usage:  ./phaseProfileTable.py [options] case ...
+#
+# Options:
+#
+#   --profile name      Only the profile of this name, e.g.
+#                       horizontalAxisWindTurbinesALMAdvanced.
+#   --scaling type      Also give the parallel efficiency of each phase over
+#                       the cases, against the case on the fewest
+#                       processors: strong (the same problem on each) or weak
+#                       (the problem grows with the processors).
+#   --baseline dir      Compare each case with the case of the same name in
+#                       dir, e.g. the same suite run with a baseline build,
+#                       and list the phases whose maximum time over the
+#                       processors has grown by more than the threshold.
+#                       The exit status is 1 if there are any.
+#   --threshold value   Fractional growth in time taken as a regression
+#                       (default 0.1).
+#
+# e.g.    ./phaseProfileTable.py --scaling strong benchmarks.strong/*
+#         ./phaseProfileTable.py --baseline baseline/benchmarks.regression \
+#                                benchmarks.regression/*
+#
+# The time of a phase is that of its slowest processor, and its imbalance the
+# ratio of that to the mean time over the processors.
+
+
+from __future__ import print_function
+
+import glob
+import os
+import sys
+
+
+
+
+# Read a phase profile file, returning the number of processors and a list of
+# (phase, values), where values holds the columns of the file by name.
+def readProfile(fileName):
+    columns = ['calls min', 'calls max', 'calls mean',
+               'time min', 'time max', 'time mean',
+               'bytes min', 'bytes max', 'bytes mean']
+
+    nProcs = 1
+    phases = []
+    for line in open(fileName):
+        words = line.split()
+        if not words:
+            continue
+        if line.startswith('#'):
+            if 'processors' in words:
+                nProcs = int(words[words.index('processors') - 1])
+            continue
+
+        values = dict(zip(columns, [float(w) for w in words[1:]]))
+        phases.append((words[0], values))
+
+    return nProcs, phases
+
+
+
+
+# Find the phase profiles of a case, returning a dictionary of
+# (nProcs, phases) by profile name.  The latest start time is taken.
+def readCase(caseDir, profileName):
+    timeDirs = glob.glob(os.path.join(caseDir,'postProcessing','phaseProfile','*'))
+    timeDirs = [d for d in timeDirs if os.path.isdir(d)]
+    if not timeDirs:
+        return {}
+
+    def timeValue(d):
+        try:
+            return float(os.path.basename(d))
+        except ValueError:
+            return 0.0
+    timeDir = max(timeDirs, key=timeValue)
+
+    profiles = {}
+    for fileName in sorted(glob.glob(os.path.join(timeDir,'*'))):
+        name = os.path.basename(fileName)
+        if (profileName is None) or (name == profileName):
+            profiles[name] = readProfile(fileName)
+
+    return profiles
+
+
+
+
+# Format a byte count.
+def formatBytes(b):
+    for unit in ['B', 'kB', 'MB', 'GB']:
+        if b < 1024.0:
+            return '%.1f %s' % (b, unit)
+        b /= 1024.0
+    return '%.1f TB' % b
+
+
+
+
+# Print the phases of each profile of a case.
+def printCase(caseDir, profiles):
+    for name in sorted(profiles):
+        nProcs, phases = profiles[name]
+        print(caseDir + ': ' + name + ' on ' + str(nProcs) + ' processors')
+        print('    %-24s %10s %12s %12s %10s %14s' %
+              ('phase', 'calls', 'time (s)', 'per call (s)', 'imbalance', 'bytes/proc'))
+        for phase, v in phases:
+            perCall = v['time max']/max(v['calls max'], 1.0)
+            imbalance = v['time max']/v['time mean'] if v['time mean'] > 0.0 else 1.0
+            print('    %-24s %10d %12.4g %12.4g %10.2f %14s' %
+                  (phase, v['calls max'], v['time max'], perCall, imbalance,
+                   formatBytes(v['bytes mean'])))
+        print('')
+
+
+
+
+# Print the parallel efficiency of each phase over the cases.
+def printScaling(cases, scaling):
+    names = set()
+    for caseDir, profiles in cases:
+        names.update(profiles)
+
+    for name in sorted(names):
+        runs = [(profiles[name][0], caseDir, dict(profiles[name][1]))
+                for caseDir, profiles in cases if name in profiles]
+        runs.sort(key=lambda r: r[0])
+        if len(runs) < 2:
+            continue
+
+        phases = []
+        for nProcs, caseDir, values in runs:
+            for phase in values:
+                if phase not in phases:
+                    phases.append(phase)
+
+        print(scaling + ' scaling of ' + name + ' (time of the slowest processor, s, and efficiency)')
+        print('    %-24s' % 'phase' + ''.join(['%20s' % ('np ' + str(r[0])) for r in runs]))
+        for phase in phases:
+            line = '    %-24s' % phase
+            ref = runs[0]
+            for nProcs, caseDir, values in runs:
+                if (phase not in values) or (phase not in ref[2]):
+                    line += '%20s' % '-'
+                    continue
+                t = values[phase]['time max']
+                tRef = ref[2][phase]['time max']
+                if t <= 0.0:
+                    efficiency = 1.0
+                elif scaling == 'strong':
+                    efficiency = tRef*ref[0]/(t*nProcs)
+                else:
+                    efficiency = tRef/t
+                line += '%20s' % ('%.4g (%3.0f%%)' % (t, 100.0*efficiency))
+            print(line)
+        print('')
+
+
+
+
+# Compare the cases with those of the baseline, returning the number of
+# regressions.
+def compareBaseline(cases, baselineDir, profileName, threshold):
+    nRegressions = 0
+    for caseDir, profiles in cases:
+        baseDir = os.path.join(baselineDir, os.path.basename(os.path.normpath(caseDir)))
+        baseProfiles = readCase(baseDir, profileName)
+        if not baseProfiles:
+            print(caseDir + ': no baseline in ' + baseDir)
+            continue
+
+        for name in sorted(profiles):
+            if name not in baseProfiles:
+                continue
+            base = dict(baseProfiles[name][1])
+            for phase, v in profiles[name][1]:
+                if phase not in base:
+                    continue
+                t = v['time max']
+                tBase = base[phase]['time max']
+                if (tBase > 0.0) and (t > (1.0 + threshold)*tBase):
+                    print('REGRESSION ' + caseDir + ': ' + name + ' ' + phase + ' ' +
+                          '%.4g s against %.4g s (+%.0f%%)' % (t, tBase, 100.0*(t/tBase - 1.0)))
+                    nRegressions += 1
+
+    if nRegressions == 0:
+        print('No phase is more than %.0f%% slower than the baseline' % (100.0*threshold))
+
+    return nRegressions
+
+
+
+
+if __name__ == '__main__':
+    profileName = None
+    scaling = None
+    baselineDir = None
+    threshold = 0.1
+    caseDirs = []
+
+    args = sys.argv[1:]
+    while args:
+        arg = args.pop(0)
+        if arg in ['--profile', '--scaling', '--baseline', '--threshold'] and not args:
+            print('Error: ' + arg + ' needs a value')
+            sys.exit(1)
+        if arg == '--profile':
+            profileName = args.pop(0)
+        elif arg == '--scaling':
+            scaling = args.pop(0)
+            if scaling not in ['strong', 'weak']:
+                print('Error: --scaling is strong or weak')
+                sys.exit(1)
+        elif arg == '--baseline':
+            baselineDir = args.pop(0)
+        elif arg == '--threshold':
+            threshold = float(args.pop(0))
+        else:
+            caseDirs.append(arg)
+
+    if not caseDirs:
+        print('Usage: ' + sys.argv[0] + ' [--profile name] [--scaling strong|weak]'
+              + ' [--baseline dir] [--threshold value] case ...')
+        sys.exit(1)
+
+    cases = []
+    for caseDir in caseDirs:
+        profiles = readCase(caseDir, profileName)
+        if not profiles:
+            print(caseDir + ': no phase profiles')
+            continue
+        printCase(caseDir, profiles)
+        cases.append((caseDir, profiles))
+
+    if scaling is not None:
+        printScaling(cases, scaling)
+
+    if baselineDir is not None:
+        if compareBaseline(cases, baselineDir, profileName, threshold) > 0:
+            sys.exit(1)